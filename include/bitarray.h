@@ -0,0 +1,273 @@
+/**
+@file bitarray.h
+@author Garett Bass (https://github.com/garettbass)
+@copyright Copyright (c) 2016 Garett Bass (https://github.com/garettbass)
+
+The MIT License (MIT)
+Copyright (c) 2016 Garett Bass (https://github.com/garettbass)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "array.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
+
+
+#if __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+
+//------------------------------------------------------------------------------
+
+
+typedef struct {
+    array_t(uint64_t) words;
+    size_t size;
+} bitarray_t;
+/**< A dynamic array of bits, packed 64 to a word.
+
+The words are stored in a regular dynamic array, so a bitarray_t grows like
+any other array, using the same allocator.  Bits past the end of the array
+are always zero.
+
+@code{.c}
+    bitarray_t flags = {0};
+    bitarray_alloc(flags, 1024);
+    bitarray_append(flags, true);
+    bitarray_append(flags, false);
+    bitarray_set(flags, 1, true);
+    assert(bitarray_popcount(flags) == 2);
+    bitarray_free(flags);
+@endcode
+**/
+
+
+// void bitarray_alloc(bitarray_t& b, size_t capacity)
+#define bitarray_alloc(b, capacity) \
+    ( array_alloc((b).words, _bitarray_word_count((capacity)), NULL), \
+      (void)((b).size = 0) )
+/**< Allocates initial storage for capacity bits.
+@hideinitializer **/
+
+
+// void bitarray_free(bitarray_t& b)
+#define bitarray_free(b) \
+    ( array_free((b).words), (void)((b).size = 0) )
+/**< Frees storage held by a bit array.
+@hideinitializer **/
+
+
+// size_t bitarray_size(bitarray_t b)
+#define bitarray_size(b) \
+    ((b).size)
+/**< Returns the number of bits stored in the bit array.
+@hideinitializer **/
+
+
+// void bitarray_resize(bitarray_t& b, size_t size)
+#define bitarray_resize(b, size) \
+    (_bitarray_resize(&(b), (size)))
+/**< Resizes the bit array.  New bits are zero.
+@hideinitializer **/
+
+
+// void bitarray_append(bitarray_t& b, bool value)
+#define bitarray_append(b, v) \
+    (_bitarray_append(&(b), (v)))
+/**< Appends a single bit to the bit array, allocating additional storage if
+necessary.
+@hideinitializer **/
+
+
+// bool bitarray_get(bitarray_t b, size_t index)
+#define bitarray_get(b, index) \
+    (_bitarray_get(&(b), (index)))
+/**< Returns the bit at index.
+@hideinitializer **/
+
+
+// void bitarray_set(bitarray_t& b, size_t index, bool value)
+#define bitarray_set(b, index, v) \
+    (_bitarray_set(&(b), (index), (v)))
+/**< Assigns the bit at index.
+@hideinitializer **/
+
+
+// size_t bitarray_popcount(bitarray_t b)
+#define bitarray_popcount(b) \
+    (_bitarray_popcount(&(b)))
+/**< Returns the number of set bits in the bit array.
+@hideinitializer **/
+
+
+// size_t bitarray_find_first_set(bitarray_t b)
+#define bitarray_find_first_set(b) \
+    (_bitarray_find_first_set(&(b)))
+/**< Returns the index of the first set bit, or bitarray_size(b) if no bit is
+set.
+@hideinitializer **/
+
+
+// void bitarray_and(bitarray_t& dst, bitarray_t src)
+#define bitarray_and(dst, src) \
+    (_bitarray_and(&(dst), &(src)))
+/**< Assigns dst the bitwise AND of dst and src, which must be the same size.
+@hideinitializer **/
+
+
+// void bitarray_or(bitarray_t& dst, bitarray_t src)
+#define bitarray_or(dst, src) \
+    (_bitarray_or(&(dst), &(src)))
+/**< Assigns dst the bitwise OR of dst and src, which must be the same size.
+@hideinitializer **/
+
+
+// void bitarray_xor(bitarray_t& dst, bitarray_t src)
+#define bitarray_xor(dst, src) \
+    (_bitarray_xor(&(dst), &(src)))
+/**< Assigns dst the bitwise XOR of dst and src, which must be the same size.
+@hideinitializer **/
+
+
+//==============================================================================
+
+
+#define _bitarray_word_count(bits) (((bits) + 63) / 64)
+
+
+//------------------------------------------------------------------------------
+
+
+static inline
+void _bitarray_resize(bitarray_t* const b, const size_t new_size) {
+    _array_t* const words = _array_ptr(b->words);
+    const size_t old_size = b->size;
+    if (new_size < old_size && (new_size & 63)) {
+        // keep the bits past the end of the array zero
+        b->words[new_size / 64] &= ~(~(uint64_t)0 << (new_size & 63));
+    }
+    _array_resize(words, _bitarray_word_count(new_size) * sizeof(uint64_t));
+    b->size = new_size;
+}
+
+
+static inline
+void _bitarray_append(bitarray_t* const b, const int value) {
+    const size_t index = b->size;
+    if ((index & 63) == 0) {
+        _array_append(_array_ptr(b->words), sizeof(uint64_t));
+        b->words[index / 64] = 0;
+    }
+    b->words[index / 64] |= (uint64_t)(value != 0) << (index & 63);
+    b->size = index + 1;
+}
+
+
+static inline
+bool _bitarray_get(const bitarray_t* const b, const size_t index) {
+    _array_assert(index < b->size, "array index out of range");
+    return (b->words[index / 64] >> (index & 63)) & 1;
+}
+
+
+static inline
+void _bitarray_set(bitarray_t* const b, const size_t index, const int value) {
+    _array_assert(index < b->size, "array index out of range");
+    const uint64_t mask = (uint64_t)1 << (index & 63);
+    uint64_t* const word = b->words + index / 64;
+    (*word) = value ? ((*word) | mask) : ((*word) & ~mask);
+}
+
+
+static inline
+size_t _bitarray_popcount(const bitarray_t* const b) {
+    const size_t word_count = _bitarray_word_count(b->size);
+    const uint64_t* const words = b->words;
+    size_t count = 0;
+    for (size_t i = 0; i < word_count; ++i) {
+        count += _array_popcount64(words[i]);
+    }
+    return count;
+}
+
+
+static inline
+size_t _bitarray_find_first_set(const bitarray_t* const b) {
+    const size_t word_count = _bitarray_word_count(b->size);
+    const uint64_t* const words = b->words;
+    for (size_t i = 0; i < word_count; ++i) {
+        if (words[i]) return i * 64 + _array_ctz64(words[i]);
+    }
+    return b->size;
+}
+
+
+// dst and src may alias, so each pair of words is loaded before it is stored
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define _bitarray_binary_op_pairs(op, sse2_op, neon_op) \
+        for (; i + 2 <= word_count; i += 2) { \
+            const __m128i x = _mm_loadu_si128((const __m128i*)(d + i)); \
+            const __m128i y = _mm_loadu_si128((const __m128i*)(s + i)); \
+            _mm_storeu_si128((__m128i*)(d + i), sse2_op(x, y)); \
+        }
+#elif defined(__ARM_NEON)
+    #define _bitarray_binary_op_pairs(op, sse2_op, neon_op) \
+        for (; i + 2 <= word_count; i += 2) { \
+            vst1q_u64(d + i, neon_op(vld1q_u64(d + i), vld1q_u64(s + i))); \
+        }
+#else
+    #define _bitarray_binary_op_pairs(op, sse2_op, neon_op)
+#endif
+
+#define _bitarray_binary_op(name, op, sse2_op, neon_op) \
+    static inline \
+    void name(bitarray_t* const dst, const bitarray_t* const src) { \
+        _array_assert(dst->size == src->size, "bitarray size mismatch"); \
+        const size_t word_count = _bitarray_word_count(dst->size); \
+        uint64_t* const d = dst->words; \
+        const uint64_t* const s = src->words; \
+        size_t i = 0; \
+        _bitarray_binary_op_pairs(op, sse2_op, neon_op) \
+        for (; i < word_count; ++i) { \
+            d[i] op s[i]; \
+        } \
+    }
+
+_bitarray_binary_op(_bitarray_and, &=, _mm_and_si128, vandq_u64)
+_bitarray_binary_op(_bitarray_or, |=, _mm_or_si128, vorrq_u64)
+_bitarray_binary_op(_bitarray_xor, ^=, _mm_xor_si128, veorq_u64)
+
+#undef _bitarray_binary_op
+#undef _bitarray_binary_op_pairs
+
+
+//------------------------------------------------------------------------------
+
+
+#if __cplusplus
+} // extern "C"
+#endif // __cplusplus
@@ -0,0 +1,287 @@
+/**
+@file packedarray.h
+@author Garett Bass (https://github.com/garettbass)
+@copyright Copyright (c) 2016 Garett Bass (https://github.com/garettbass)
+
+The MIT License (MIT)
+Copyright (c) 2016 Garett Bass (https://github.com/garettbass)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <stdint.h>
+#include "array.h"
+
+
+#if __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+
+//------------------------------------------------------------------------------
+
+
+enum { PACKEDARRAY_BLOCK_SIZE = 128 };
+
+
+typedef struct {
+    uint64_t base; // minimum value in the block
+    uint64_t bit_offset; // offset of the block's first packed value
+    uint32_t width; // bits per packed value
+    uint32_t size; // number of values in the block
+} _packedarray_block_t;
+
+
+typedef struct {
+    array_t(_packedarray_block_t) blocks;
+    array_t(uint64_t) words;
+    size_t size;
+} packedarray_t;
+/**< An immutable array of 32 or 64-bit unsigned integers, compressed by
+frame-of-reference encoding and bit-packing.
+
+Values are encoded in blocks of PACKEDARRAY_BLOCK_SIZE.  Each block stores its
+minimum value, and packs the difference between each value and that minimum
+into as few bits as the block's range requires.  Sorted keys, whose blocks
+span narrow ranges, compress especially well.  Individual values can be read
+in O(1), and whole blocks can be decoded into a regular dynamic array.
+
+@code{.c}
+    array_t(uint32_t) keys = NULL;
+    // ...
+
+    packedarray_t packed = {0};
+    packedarray_encode(packed, keys);
+    assert(packedarray_get(packed, 10) == keys[10]);
+
+    array_t(uint32_t) block = NULL;
+    array_alloc(block, PACKEDARRAY_BLOCK_SIZE, NULL);
+    for (size_t i = 0; i < packedarray_block_count(packed); ++i) {
+        array_clear(block);
+        packedarray_decode_block(packed, i, block);
+        // ...
+    }
+
+    array_free(block);
+    packedarray_free(packed);
+@endcode
+**/
+
+
+// void packedarray_encode(packedarray_t& p, T* a)
+#define packedarray_encode(p, a) \
+    (_packedarray_encode(&(p), _array_ptr((a)), _array_stride((a))))
+/**< Encodes the elements of a, an array of uint32_t or uint64_t, into the
+packed array p, which must be empty.
+@hideinitializer **/
+
+
+// void packedarray_free(packedarray_t& p)
+#define packedarray_free(p) \
+    ( array_free((p).blocks), array_free((p).words), (void)((p).size = 0) )
+/**< Frees storage held by a packed array.
+@hideinitializer **/
+
+
+// size_t packedarray_size(packedarray_t p)
+#define packedarray_size(p) \
+    ((p).size)
+/**< Returns the number of values stored in the packed array.
+@hideinitializer **/
+
+
+// size_t packedarray_block_count(packedarray_t p)
+#define packedarray_block_count(p) \
+    (array_size((p).blocks))
+/**< Returns the number of blocks in the packed array.
+@hideinitializer **/
+
+
+// uint64_t packedarray_get(packedarray_t p, size_t index)
+#define packedarray_get(p, index) \
+    (_packedarray_get(&(p), (index)))
+/**< Returns the value at index.
+@hideinitializer **/
+
+
+// void packedarray_decode_block(packedarray_t p, size_t block, T*& a)
+#define packedarray_decode_block(p, block, a) \
+    (_packedarray_decode_block(&(p), (block), _array_ptr((a)), _array_stride((a))))
+/**< Appends the values of a block to a, an array of uint32_t or uint64_t,
+allocating additional storage if necessary.
+@hideinitializer **/
+
+
+//==============================================================================
+
+
+static inline
+uint64_t _packedarray_mask(const uint32_t width) {
+    return (width < 64) ? (((uint64_t)1 << width) - 1) : ~((uint64_t)0);
+}
+
+
+static inline
+uint64_t _packedarray_unpack(const uint64_t* const words, const uint64_t bit_offset, const uint32_t width) {
+    const size_t word = (size_t)(bit_offset / 64);
+    const unsigned shift = (unsigned)(bit_offset & 63);
+    uint64_t value = words[word] >> shift;
+    if (shift + width > 64) {
+        value |= words[word + 1] << (64 - shift);
+    }
+    return value & _packedarray_mask(width);
+}
+
+
+static inline
+void _packedarray_pack(uint64_t* const words, const uint64_t bit_offset, const uint32_t width, const uint64_t delta) {
+    const size_t word = (size_t)(bit_offset / 64);
+    const unsigned shift = (unsigned)(bit_offset & 63);
+    words[word] |= delta << shift;
+    if (shift + width > 64) {
+        words[word + 1] |= delta >> (64 - shift);
+    }
+}
+
+
+// appends a block descriptor and zeroed storage for its packed values
+static inline
+const _packedarray_block_t* _packedarray_append_block(
+    packedarray_t* const p,
+    const uint64_t min,
+    const uint64_t max,
+    const size_t size
+) {
+    const size_t block_count = array_size(p->blocks);
+    const uint64_t bit_offset = block_count
+        ? array_back(p->blocks).bit_offset +
+          (uint64_t)array_back(p->blocks).width * array_back(p->blocks).size
+        : 0;
+    _packedarray_block_t block;
+    block.base = min;
+    block.bit_offset = bit_offset;
+    block.width = _array_bit_width64(max - min);
+    block.size = (uint32_t)size;
+    array_append(p->blocks, block);
+
+    // one spare word lets _packedarray_unpack() always read two words
+    const uint64_t bit_end = bit_offset + (uint64_t)block.width * block.size;
+    array_resize(p->words, (size_t)((bit_end + 63) / 64) + 1);
+    return &array_back(p->blocks);
+}
+
+
+#define _packedarray_typed_ops(T) \
+    static inline \
+    void _packedarray_encode_##T(packedarray_t* const p, const T* const values, const size_t size) { \
+        for (size_t begin = 0; begin < size; begin += PACKEDARRAY_BLOCK_SIZE) { \
+            const size_t remaining = size - begin; \
+            const size_t count = \
+                (remaining < PACKEDARRAY_BLOCK_SIZE) ? remaining : PACKEDARRAY_BLOCK_SIZE; \
+            const T* const block_values = values + begin; \
+            T min = block_values[0], max = block_values[0]; \
+            for (size_t i = 1; i < count; ++i) { \
+                min = (block_values[i] < min) ? block_values[i] : min; \
+                max = (block_values[i] > max) ? block_values[i] : max; \
+            } \
+            const _packedarray_block_t* const block = \
+                _packedarray_append_block(p, min, max, count); \
+            const uint32_t width = block->width; \
+            if (!width) continue; \
+            uint64_t* const words = p->words; \
+            uint64_t bit_offset = block->bit_offset; \
+            for (size_t i = 0; i < count; ++i, bit_offset += width) { \
+                _packedarray_pack(words, bit_offset, width, (uint64_t)(block_values[i] - min)); \
+            } \
+        } \
+    } \
+    \
+    static inline \
+    void _packedarray_decode_##T(const _packedarray_block_t* const block, const uint64_t* const words, T* const dst) { \
+        const uint32_t width = block->width; \
+        const T base = (T)block->base; \
+        uint64_t bit_offset = block->bit_offset; \
+        for (size_t i = 0; i < block->size; ++i, bit_offset += width) { \
+            dst[i] = base + (T)_packedarray_unpack(words, bit_offset, width); \
+        } \
+    }
+
+_packedarray_typed_ops(uint32_t)
+_packedarray_typed_ops(uint64_t)
+
+#undef _packedarray_typed_ops
+
+
+static inline
+void _packedarray_check_stride(const size_t stride) {
+    _array_assert(stride == sizeof(uint32_t) || stride == sizeof(uint64_t),
+        "packedarray element size must be 4 or 8 bytes");
+}
+
+
+static inline
+void _packedarray_encode(packedarray_t* const p, _array_t* const a, const size_t stride) {
+    _array_assert(!p->blocks && !p->words, "packedarray already encoded");
+    _packedarray_check_stride(stride);
+    const size_t size = _array_size(a) / stride;
+    const size_t block_count =
+        (size + PACKEDARRAY_BLOCK_SIZE - 1) / PACKEDARRAY_BLOCK_SIZE;
+    array_alloc(p->blocks, block_count, NULL);
+    array_alloc(p->words, 0, NULL);
+    p->size = size;
+    if (stride == sizeof(uint32_t)) {
+        _packedarray_encode_uint32_t(p, (const uint32_t*)(*a), size);
+    } else {
+        _packedarray_encode_uint64_t(p, (const uint64_t*)(*a), size);
+    }
+}
+
+
+static inline
+uint64_t _packedarray_get(const packedarray_t* const p, const size_t index) {
+    _array_assert(index < p->size, "array index out of range");
+    const _packedarray_block_t* const block =
+        p->blocks + index / PACKEDARRAY_BLOCK_SIZE;
+    const size_t offset = index % PACKEDARRAY_BLOCK_SIZE;
+    const uint64_t bit_offset = block->bit_offset + (uint64_t)block->width * offset;
+    return block->base + _packedarray_unpack(p->words, bit_offset, block->width);
+}
+
+
+static inline
+void _packedarray_decode_block(const packedarray_t* const p, const size_t block_index, _array_t* const a, const size_t stride) {
+    _array_assert(block_index < array_size(p->blocks), "array index out of range");
+    _packedarray_check_stride(stride);
+    const _packedarray_block_t* const block = p->blocks + block_index;
+    const size_t append_offset = _array_append(a, block->size * stride);
+    char* const dst = (*a) + append_offset;
+    if (stride == sizeof(uint32_t)) {
+        _packedarray_decode_uint32_t(block, p->words, (uint32_t*)dst);
+    } else {
+        _packedarray_decode_uint64_t(block, p->words, (uint64_t*)dst);
+    }
+}
+
+
+//------------------------------------------------------------------------------
+
+
+#if __cplusplus
+} // extern "C"
+#endif // __cplusplus
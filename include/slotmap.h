@@ -0,0 +1,296 @@
+/**
+@file slotmap.h
+@author Garett Bass (https://github.com/garettbass)
+@copyright Copyright (c) 2016 Garett Bass (https://github.com/garettbass)
+
+The MIT License (MIT)
+Copyright (c) 2016 Garett Bass (https://github.com/garettbass)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "array.h"
+
+
+#if __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+
+//------------------------------------------------------------------------------
+
+
+typedef uint64_t slotmap_handle_t;
+/**< A generational handle to an element of a slot map.  The low 32 bits hold
+the slot index, and the high 32 bits hold the slot's generation.  Zero is
+never a valid handle.
+**/
+
+
+#define slotmap_t(T) \
+    struct { \
+        array_t(T) values; \
+        array_t(uint32_t) owners; \
+        array_t(_slotmap_slot_t) slots; \
+        uint32_t free_slot; \
+    }
+/**< Declares a slot map, a dynamic array of elements addressed by stable
+handles.
+
+Elements are stored densely in the `values` array, so iteration is as fast as
+iterating any other dynamic array, but their order is unspecified.  Insertion,
+removal, and lookup by handle are all O(1).  A zero-initialized slot map must
+be allocated with slotmap_alloc() before use.
+
+@code{.c}
+    typedef slotmap_t(entity_t) entity_map;
+
+    entity_map entities = {0};
+    slotmap_alloc(entities, 16, NULL);
+
+    slotmap_handle_t h = slotmap_insert(entities, some_entity);
+    entity_t* e = slotmap_get(entities, h);
+
+    const entity_t* const end = array_end(entities.values);
+    for (entity_t* itr = array_begin(entities.values); itr < end; ++itr) {
+        // ...
+    }
+
+    slotmap_remove(entities, h);
+    assert(slotmap_get(entities, h) == NULL);
+
+    slotmap_free(entities);
+@endcode
+@hideinitializer **/
+
+
+// void slotmap_alloc(slotmap_t(T)& m, size_t capacity, void (*destructor)(T* begin, T* end))
+#define slotmap_alloc(m, capacity, destructor) \
+    ( array_alloc((m).values, (capacity), (destructor)), \
+      array_alloc((m).owners, (capacity), NULL), \
+      array_alloc((m).slots, (capacity), NULL), \
+      (void)((m).free_slot = 0) )
+/**< Allocates initial storage for a slot map.  The optional destructor is
+called by slotmap_remove, slotmap_clear, and slotmap_free.
+@hideinitializer **/
+
+
+// void slotmap_free(slotmap_t(T)& m)
+#define slotmap_free(m) \
+    ( array_free((m).values), \
+      array_free((m).owners), \
+      array_free((m).slots), \
+      (void)((m).free_slot = 0) )
+/**< Frees storage held by a slot map.  Elements are passed to the slot map's
+destructor if it is not NULL.
+@hideinitializer **/
+
+
+// size_t slotmap_size(slotmap_t(T) m)
+#define slotmap_size(m) \
+    (array_size((m).values))
+/**< Returns the number of elements stored in the slot map.
+@hideinitializer **/
+
+
+// slotmap_handle_t slotmap_insert(slotmap_t(T)& m, T value)
+#define slotmap_insert(m, v) \
+    ( _slotmap_insert(_array_ptr((m).values), _array_ptr((m).owners), _array_ptr((m).slots), &(m).free_slot, _array_stride((m).values)), \
+      array_back((m).values) = v, \
+      _slotmap_handle(_array_ptr((m).owners), _array_ptr((m).slots), array_size((m).values) - 1) )
+/**< Inserts a single element into the slot map, allocating additional storage
+if necessary, and returns its handle.
+@hideinitializer **/
+
+
+// T* slotmap_get(slotmap_t(T) m, slotmap_handle_t handle)
+#define slotmap_get(m, handle) \
+    ( slotmap_contains(m, handle) \
+        ? (m).values + _slotmap_index(_array_ptr((m).slots), (handle)) \
+        : NULL )
+/**< Returns a pointer to the element referred to by handle, or NULL if the
+element has been removed.  The pointer remains valid until the slot map is
+next modified.
+@hideinitializer **/
+
+
+// bool slotmap_contains(slotmap_t(T) m, slotmap_handle_t handle)
+#define slotmap_contains(m, handle) \
+    (_slotmap_contains(_array_ptr((m).slots), (handle)))
+/**< Returns true if handle refers to an element of the slot map.
+@hideinitializer **/
+
+
+// slotmap_handle_t slotmap_handle(slotmap_t(T) m, size_t index)
+#define slotmap_handle(m, index) \
+    (_slotmap_handle(_array_ptr((m).owners), _array_ptr((m).slots), (index)))
+/**< Returns the handle of the element at index in the slot map's `values`
+array.
+@hideinitializer **/
+
+
+// bool slotmap_remove(slotmap_t(T)& m, slotmap_handle_t handle)
+#define slotmap_remove(m, handle) \
+    (_slotmap_remove(_array_ptr((m).values), _array_ptr((m).owners), _array_ptr((m).slots), &(m).free_slot, _array_stride((m).values), (handle)))
+/**< Removes the element referred to by handle from the slot map.  The removed
+element is passed to the slot map's destructor if it is not NULL, and is
+replaced by the final element of the `values` array.  Handles to all other
+elements remain valid.  Returns false, and does nothing, if the handle does not
+refer to an element, e.g. if it was already removed.
+@hideinitializer **/
+
+
+// void slotmap_clear(slotmap_t(T)& m)
+#define slotmap_clear(m) \
+    (_slotmap_clear(_array_ptr((m).values), _array_ptr((m).owners), _array_ptr((m).slots), &(m).free_slot))
+/**< Removes all elements from the slot map.  Removed elements are passed to
+the slot map's destructor if it is not NULL.
+@hideinitializer **/
+
+
+//==============================================================================
+
+
+typedef struct {
+    uint32_t index; // dense index when live, next free slot + 1 when free
+    uint32_t generation; // odd when live, even when free
+} _slotmap_slot_t;
+
+
+//------------------------------------------------------------------------------
+
+
+static inline
+void _slotmap_insert(
+    _array_t* const values,
+    _array_t* const owners,
+    _array_t* const slots,
+    uint32_t* const free_slot,
+    const size_t stride
+) {
+    const size_t index = _array_append(values, stride) / stride;
+    _array_assert(index < UINT32_MAX, "slotmap full");
+    uint32_t slot = (*free_slot);
+    if (slot) {
+        slot -= 1;
+        (*free_slot) = ((_slotmap_slot_t*)(*slots))[slot].index;
+    } else {
+        slot = (uint32_t)(_array_size(slots) / sizeof(_slotmap_slot_t));
+        _array_append(slots, sizeof(_slotmap_slot_t));
+        ((_slotmap_slot_t*)(*slots))[slot].generation = 0;
+    }
+    _slotmap_slot_t* const s = ((_slotmap_slot_t*)(*slots)) + slot;
+    s->index = (uint32_t)index;
+    s->generation += 1;
+    _array_append(owners, sizeof(uint32_t));
+    ((uint32_t*)(*owners))[index] = slot;
+}
+
+
+static inline
+slotmap_handle_t _slotmap_handle(
+    _array_t* const owners,
+    _array_t* const slots,
+    const size_t index
+) {
+    _array_assert(index < _array_size(owners) / sizeof(uint32_t), "array index out of range");
+    const uint32_t slot = ((uint32_t*)(*owners))[index];
+    const uint32_t generation = ((_slotmap_slot_t*)(*slots))[slot].generation;
+    return ((slotmap_handle_t)generation << 32) | slot;
+}
+
+
+static inline
+bool _slotmap_contains(_array_t* const slots, const slotmap_handle_t handle) {
+    const uint32_t slot = (uint32_t)handle;
+    const uint32_t generation = (uint32_t)(handle >> 32);
+    if (!(generation & 1)) return false;
+    if (slot >= _array_size(slots) / sizeof(_slotmap_slot_t)) return false;
+    return ((_slotmap_slot_t*)(*slots))[slot].generation == generation;
+}
+
+
+static inline
+size_t _slotmap_index(_array_t* const slots, const slotmap_handle_t handle) {
+    _array_assert(_slotmap_contains(slots, handle), "slotmap handle invalid");
+    return ((_slotmap_slot_t*)(*slots))[(uint32_t)handle].index;
+}
+
+
+static inline
+void _slotmap_release(
+    _array_t* const slots,
+    uint32_t* const free_slot,
+    const uint32_t slot
+) {
+    _slotmap_slot_t* const s = ((_slotmap_slot_t*)(*slots)) + slot;
+    s->index = (*free_slot);
+    s->generation += 1;
+    (*free_slot) = slot + 1;
+}
+
+
+static inline
+bool _slotmap_remove(
+    _array_t* const values,
+    _array_t* const owners,
+    _array_t* const slots,
+    uint32_t* const free_slot,
+    const size_t stride,
+    const slotmap_handle_t handle
+) {
+    if (!_slotmap_contains(slots, handle)) return false;
+    const size_t index = _slotmap_index(slots, handle);
+    const uint32_t slot = (uint32_t)handle;
+    _array_remove_unordered(values, index * stride, stride);
+    _array_remove_unordered(owners, index * sizeof(uint32_t), sizeof(uint32_t));
+    if (index < _array_size(owners) / sizeof(uint32_t)) {
+        const uint32_t moved_slot = ((uint32_t*)(*owners))[index];
+        ((_slotmap_slot_t*)(*slots))[moved_slot].index = (uint32_t)index;
+    }
+    _slotmap_release(slots, free_slot, slot);
+    return true;
+}
+
+
+static inline
+void _slotmap_clear(
+    _array_t* const values,
+    _array_t* const owners,
+    _array_t* const slots,
+    uint32_t* const free_slot
+) {
+    _array_clear(values);
+    const uint32_t* const owners_begin = (uint32_t*)(*owners);
+    const uint32_t* const owners_end = owners_begin + _array_size(owners) / sizeof(uint32_t);
+    for (const uint32_t* itr = owners_begin; itr < owners_end; ++itr) {
+        _slotmap_release(slots, free_slot, *itr);
+    }
+    _array_clear(owners);
+}
+
+
+//------------------------------------------------------------------------------
+
+
+#if __cplusplus
+} // extern "C"
+#endif // __cplusplus
@@ -0,0 +1,132 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <array.h>
+#include <bitarray.h>
+#include <packedarray.h>
+
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+
+static volatile uint64_t sink;
+
+
+static double mb(const size_t bytes) {
+    return bytes / (double)(1 << 20);
+}
+
+
+// best of several runs, in milliseconds
+#define BENCH(result, expr) { \
+    result = 0; \
+    for (int run = 0; run < 5; ++run) { \
+        const double begin = now_ms(); \
+        expr; \
+        const double elapsed = now_ms() - begin; \
+        result = (run == 0 || elapsed < result) ? elapsed : result; \
+    } \
+}
+
+
+static void bench_bits(const size_t n) {
+    array_t(bool) flags = NULL;
+    bitarray_t bits = {0}, mask = {0};
+    array_alloc(flags, n, NULL);
+    bitarray_alloc(bits, n);
+    bitarray_alloc(mask, n);
+    uint32_t x = 2463534242u;
+    for (size_t i = 0; i < n; ++i) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        array_append(flags, (x & 7) == 0);
+        bitarray_append(bits, (x & 7) == 0);
+        bitarray_append(mask, (x & 3) == 0);
+    }
+
+    double flags_ms, bits_ms, and_ms;
+    BENCH(flags_ms, {
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i) count += flags[i];
+        sink = count;
+    })
+    BENCH(bits_ms, sink = bitarray_popcount(bits))
+    BENCH(and_ms, bitarray_and(bits, mask))
+
+    printf("%zu flags\n", n);
+    printf("  array_t(bool)  %8.2f MB  count %8.2f ms\n",
+        mb(array_capacity(flags) * sizeof(bool)), flags_ms);
+    printf("  bitarray_t     %8.2f MB  count %8.2f ms  and %8.2f ms (%.1f GB/s)\n",
+        mb(array_capacity(bits.words) * sizeof(uint64_t)), bits_ms, and_ms,
+        3 * mb(array_size(bits.words) * sizeof(uint64_t)) / 1024 / (and_ms / 1e3));
+
+    array_free(flags);
+    bitarray_free(bits);
+    bitarray_free(mask);
+}
+
+
+static void bench_keys(const size_t n) {
+    array_t(uint32_t) keys = NULL;
+    array_alloc(keys, n, NULL);
+    uint32_t key = 0, x = 2463534242u;
+    for (size_t i = 0; i < n; ++i) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        key += 1 + (x & 15);
+        array_append(keys, key);
+    }
+
+    packedarray_t packed = {0};
+    packedarray_encode(packed, keys);
+    array_t(uint32_t) block = NULL;
+    array_alloc(block, PACKEDARRAY_BLOCK_SIZE, NULL);
+
+    double scan_ms, get_ms, decode_ms;
+    BENCH(scan_ms, {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) sum += keys[i];
+        sink = sum;
+    })
+    BENCH(get_ms, {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) sum += packedarray_get(packed, i);
+        sink = sum;
+    })
+    BENCH(decode_ms, {
+        uint64_t sum = 0;
+        const size_t block_count = packedarray_block_count(packed);
+        for (size_t b = 0; b < block_count; ++b) {
+            array_clear(block);
+            packedarray_decode_block(packed, b, block);
+            const size_t size = array_size(block);
+            for (size_t i = 0; i < size; ++i) sum += block[i];
+        }
+        sink = sum;
+    })
+
+    const size_t packed_bytes =
+        array_size(packed.words) * sizeof(uint64_t) +
+        array_size(packed.blocks) * sizeof(packed.blocks[0]);
+    printf("%zu sorted uint32_t keys\n", n);
+    printf("  array_t(uint32_t)  %8.2f MB  scan %8.2f ms\n",
+        mb(array_size(keys) * sizeof(uint32_t)), scan_ms);
+    printf("  packedarray_t      %8.2f MB  get  %8.2f ms  decode_block %8.2f ms\n",
+        mb(packed_bytes), get_ms, decode_ms);
+
+    array_free(block);
+    packedarray_free(packed);
+    array_free(keys);
+}
+
+
+int main(int argc, const char* argv[]) {
+    const size_t n = (argc > 1) ? (size_t)atol(argv[1]) : (size_t)1 << 26;
+    bench_bits(n);
+    bench_keys(n);
+}
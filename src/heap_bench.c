@@ -0,0 +1,75 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <array.h>
+
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+
+static int u32_compare(const uint32_t* a, const uint32_t* b, void* context) {
+    return (*a > *b) - (*a < *b);
+}
+
+
+static volatile uint64_t sink;
+
+
+// returns nanoseconds per push + pop pair
+static double bench(array_t(uint32_t)* queue, const size_t n, const size_t arity) {
+    array_t(uint32_t) q = *queue;
+    array_clear(q);
+    uint32_t x = 2463534242u;
+    uint64_t sum = 0;
+    const double begin = now_ns();
+    for (size_t i = 0; i < n; ++i) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        array_heap_push(q, x, arity, u32_compare, NULL);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        sum += array_heap_pop(q, arity, u32_compare, NULL);
+    }
+    const double elapsed = now_ns() - begin;
+    sink = sum;
+    *queue = q;
+    return elapsed / (double)n;
+}
+
+
+int main(int argc, const char* argv[]) {
+    const int max_exponent = (argc > 1) ? atoi(argv[1]) : 7;
+    static const size_t arities[] = { 2, 4, 8 };
+    enum { ARITY_COUNT = sizeof(arities) / sizeof(arities[0]) };
+
+    array_t(uint32_t) q = NULL;
+    array_alloc(q, 0, NULL);
+
+    printf("%10s", "n");
+    for (int j = 0; j < ARITY_COUNT; ++j) {
+        printf("  %7zu-ary", arities[j]);
+    }
+    printf("   (ns per push + pop)\n");
+
+    size_t n = 1000;
+    for (int e = 3; e <= max_exponent; ++e, n *= 10) {
+        const int runs = (e <= 5) ? 5 : (e <= 6) ? 3 : 1;
+        printf("%10zu", n);
+        for (int j = 0; j < ARITY_COUNT; ++j) {
+            double best = 0;
+            for (int r = 0; r < runs; ++r) {
+                const double t = bench(&q, n, arities[j]);
+                best = (r == 0 || t < best) ? t : best;
+            }
+            printf("  %11.1f", best);
+        }
+        printf("\n");
+    }
+
+    array_free(q);
+}
@@ -0,0 +1,168 @@
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#define ARRAY_HUGEPAGES
+#include <array.h>
+
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+
+
+//------------------------------------------------------------------------------
+
+
+typedef struct {
+    int fd;
+} counter_t;
+
+
+static counter_t counter_open(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    counter_t c;
+    c.fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    return c;
+}
+
+
+static void counter_start(counter_t c) {
+    if (c.fd < 0) return;
+    ioctl(c.fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(c.fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+
+// returns -1 if the counter is unavailable
+static long long counter_stop(counter_t c) {
+    if (c.fd < 0) return -1;
+    ioctl(c.fd, PERF_EVENT_IOC_DISABLE, 0);
+    long long value = 0;
+    if (read(c.fd, &value, sizeof(value)) != sizeof(value)) return -1;
+    return value;
+}
+
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+
+static long minor_faults(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+}
+
+
+static void* realloc_allocator(void* ptr, size_t size) {
+    return size ? realloc(ptr, size) : (free(ptr), (void*)NULL);
+}
+
+
+static long anon_huge_kb(void) {
+    FILE* f = fopen("/proc/self/smaps_rollup", "r");
+    if (!f) return -1;
+    char line[256];
+    long kb = -1;
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "AnonHugePages: %ld kB", &kb) == 1) break;
+    }
+    fclose(f);
+    return kb;
+}
+
+
+static volatile uint64_t sink;
+
+
+//------------------------------------------------------------------------------
+
+
+static void bench(const char* name, void* (*allocator)(void*, size_t), const size_t size) {
+    counter_t tlb = counter_open(PERF_TYPE_HW_CACHE,
+        PERF_COUNT_HW_CACHE_DTLB |
+        (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+
+    // grow from a small array, as array_append() would, then touch the new
+    // capacity once
+    array_t(uint64_t) a = NULL;
+    array_alloc_with_allocator(a, 4096 / sizeof(uint64_t), allocator, NULL);
+    const double reserve_begin = now_ms();
+    array_reserve(a, size / sizeof(uint64_t));
+    const double reserve_ms = now_ms() - reserve_begin;
+
+    const long faults_before = minor_faults();
+    const double touch_begin = now_ms();
+    array_resize(a, size / sizeof(uint64_t));
+    const double touch_ms = now_ms() - touch_begin;
+    const long touch_faults = minor_faults() - faults_before;
+    const long huge_kb = anon_huge_kb();
+
+    // random reads across the whole array
+    const size_t count = array_size(a);
+    const size_t reads = 1 << 24;
+    uint64_t x = 88172645463325252ull, sum = 0;
+    counter_start(tlb);
+    const double read_begin = now_ms();
+    for (size_t i = 0; i < reads; ++i) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        sum += a[x % count];
+    }
+    const double read_ms = now_ms() - read_begin;
+    const long long tlb_misses = counter_stop(tlb);
+
+    printf("%-10s reserve %8.2f ms  first touch %8.2f ms  %8ld faults  "
+           "THP %7ld kB  random reads %8.2f ms  dTLB misses ",
+        name, reserve_ms, touch_ms, touch_faults, huge_kb, read_ms);
+    if (tlb_misses < 0) {
+        printf("n/a");
+    } else {
+        printf("%lld", tlb_misses);
+    }
+    printf("\n");
+    sink = sum;
+
+    array_free(a);
+    if (tlb.fd >= 0) close(tlb.fd);
+}
+
+
+int main(int argc, const char* argv[]) {
+    const size_t size_mb = (argc > 1) ? (size_t)atol(argv[1]) : 256;
+    const size_t size = size_mb << 20;
+    printf("%zu MB, ARRAY_HUGEPAGES_PREFAULT=%d\n",
+        size_mb, ARRAY_HUGEPAGES_PREFAULT);
+    for (int run = 0; run < 3; ++run) {
+        bench("realloc", realloc_allocator, size);
+        bench("hugepage", array_hugepage_allocator, size);
+    }
+}
+
+
+#else // __linux__
+
+
+int main(int argc, const char* argv[]) {
+    puts("hugepage benchmark requires Linux");
+}
+
+
+#endif // __linux__
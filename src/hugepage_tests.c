@@ -0,0 +1,147 @@
+#if !defined(_GNU_SOURCE) && !defined(_DEFAULT_SOURCE)
+    #define _GNU_SOURCE
+#endif
+#include <stdbool.h>
+#include <stdio.h>
+#define ARRAY_HUGEPAGES
+#include <array.h>
+
+
+#ifndef test
+    void exit(int);
+    static inline
+    void test_failed(const char* file, const int line, const char* msg) {
+        printf("%s:%i: %s\n", file, line, msg);
+        exit(1);
+    }
+    #define test(expr) \
+        (((expr) ? 0 : test_failed(__FILE__, __LINE__, "test("#expr") failed")))
+#endif
+
+
+#ifdef __linux__
+
+
+static size_t destructed_element_count = 0;
+
+
+void destructed_element_count_destructor(int* begin, int* end) {
+    for(; begin < end; ++begin) {
+        destructed_element_count += 1;
+    }
+}
+
+
+static size_t hugepage_block(int* a) {
+    return (size_t)a - _ARRAY_HUGEPAGE_HEAD;
+}
+
+
+static size_t hugepage_mapped_size(int* a) {
+    return ((const size_t*)hugepage_block(a))[0];
+}
+
+
+static bool hugepage_aligned(int* a) {
+    return (size_t)a % _ARRAY_HUGEPAGE_SIZE == 0;
+}
+
+
+// the elements' huge pages, plus the 4KB page holding the header
+static bool hugepage_mapped_exactly(int* a) {
+    const size_t bytes = array_capacity(a) * sizeof(int);
+    const size_t huge_bytes = (bytes + _ARRAY_HUGEPAGE_SIZE - 1)
+        / _ARRAY_HUGEPAGE_SIZE * _ARRAY_HUGEPAGE_SIZE;
+    return hugepage_mapped_size(a) == _ARRAY_HUGEPAGE_LEAD + huge_bytes;
+}
+
+
+int main(int argc, const char* argv[]) {
+    enum {
+        TEST_LENGTH = 1024,
+        HUGE_LENGTH = (4 << 20) / sizeof(int),
+    };
+
+    array_t(int) a = NULL;
+
+
+    // small arrays use malloc()
+    array_alloc(a, 0, destructed_element_count_destructor);
+    for (int i = 0; i < TEST_LENGTH; ++i) {
+        array_append(a, i);
+    }
+    test(hugepage_mapped_size(a) == 0);
+
+
+    // growing past the threshold maps aligned storage
+    array_reserve(a, HUGE_LENGTH);
+    test(array_size(a) == TEST_LENGTH);
+    test(array_capacity(a) >= HUGE_LENGTH);
+    test(hugepage_mapped_exactly(a));
+    test(hugepage_mapped_size(a) == _ARRAY_HUGEPAGE_LEAD + HUGE_LENGTH * sizeof(int));
+    test(hugepage_aligned(a));
+    for (int i = 0; i < TEST_LENGTH; ++i) {
+        test(a[i] == i);
+    }
+
+
+    // growing a mapped array maps larger aligned storage
+    const size_t old_mapped_size = hugepage_mapped_size(a);
+    for (int i = TEST_LENGTH; i <= HUGE_LENGTH; ++i) {
+        array_append(a, i);
+    }
+    test(array_size(a) == HUGE_LENGTH + 1);
+    test(array_capacity(a) >= HUGE_LENGTH + 1);
+    test(hugepage_mapped_size(a) > old_mapped_size);
+    test(hugepage_mapped_exactly(a));
+    test(hugepage_aligned(a));
+    for (int i = 0; i <= HUGE_LENGTH; ++i) {
+        test(a[i] == i);
+    }
+
+
+    // shrinking below the threshold returns to malloc()
+    array_resize(a, TEST_LENGTH);
+    test(destructed_element_count == HUGE_LENGTH + 1 - TEST_LENGTH);
+    destructed_element_count = 0;
+    array_shrink(a);
+    test(array_size(a) == TEST_LENGTH);
+    test(array_capacity(a) == TEST_LENGTH);
+    test(hugepage_mapped_size(a) == 0);
+    for (int i = 0; i < TEST_LENGTH; ++i) {
+        test(a[i] == i);
+    }
+
+
+    // freeing a mapped array unmaps it
+    array_resize(a, HUGE_LENGTH);
+    test(hugepage_mapped_size(a) != 0);
+    test(hugepage_mapped_exactly(a));
+    test(hugepage_aligned(a));
+    for (int i = 0; i < TEST_LENGTH; ++i) {
+        test(a[i] == i);
+    }
+    for (int i = TEST_LENGTH; i < HUGE_LENGTH; ++i) {
+        test(a[i] == 0);
+    }
+    array_free(a);
+    test(a == NULL);
+    test(array_size(a) == 0);
+    test(array_capacity(a) == 0);
+    test(destructed_element_count == HUGE_LENGTH);
+    destructed_element_count = 0;
+
+
+    puts("hugepage tests passed");
+}
+
+
+#else // __linux__
+
+
+int main(int argc, const char* argv[]) {
+    puts("hugepage tests skipped");
+}
+
+
+#endif // __linux__
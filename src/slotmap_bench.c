@@ -0,0 +1,237 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <array.h>
+#include <slotmap.h>
+
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+
+static uint32_t next_random(uint32_t* x) {
+    (*x) ^= (*x) << 13; (*x) ^= (*x) >> 17; (*x) ^= (*x) << 5;
+    return (*x);
+}
+
+
+static volatile uint64_t sink;
+
+
+typedef struct {
+    float position[3], velocity[3];
+    uint32_t id;
+    bool alive;
+} entity_t;
+
+
+// entity churn: each frame removes and inserts `churn` random entities, then
+// updates every live entity and looks up `churn` random handles
+static double bench_slotmap(const size_t n, const size_t churn, const int frames) {
+    typedef slotmap_t(entity_t) entity_map;
+    entity_map m = {0};
+    array_t(slotmap_handle_t) handles = NULL;
+    slotmap_alloc(m, n, NULL);
+    array_alloc(handles, n, NULL);
+    entity_t e = {{0, 0, 0}, {1, 1, 1}, 0, true};
+    for (size_t i = 0; i < n; ++i) {
+        e.id = (uint32_t)i;
+        array_append(handles, slotmap_insert(m, e));
+    }
+
+    uint32_t x = 2463534242u;
+    uint64_t sum = 0;
+    const double begin = now_ms();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (size_t i = 0; i < churn; ++i) {
+            const size_t victim = next_random(&x) % n;
+            slotmap_remove(m, handles[victim]);
+            e.id = x;
+            handles[victim] = slotmap_insert(m, e);
+        }
+        const size_t size = slotmap_size(m);
+        for (size_t i = 0; i < size; ++i) {
+            entity_t* const itr = m.values + i;
+            itr->position[0] += itr->velocity[0];
+            sum += itr->id;
+        }
+        for (size_t i = 0; i < churn; ++i) {
+            sum += slotmap_get(m, handles[next_random(&x) % n])->id;
+        }
+    }
+    const double elapsed = now_ms() - begin;
+    sink = sum;
+
+    array_free(handles);
+    slotmap_free(m);
+    return elapsed / frames;
+}
+
+
+// the same workload on a plain array whose indices stay stable because
+// removed entities leave holes that are recycled through a free list
+static double bench_holes(const size_t n, const size_t churn, const int frames) {
+    array_t(entity_t) entities = NULL;
+    array_t(uint32_t) free_list = NULL;
+    array_t(uint32_t) handles = NULL;
+    array_alloc(entities, n, NULL);
+    array_alloc(free_list, n, NULL);
+    array_alloc(handles, n, NULL);
+    entity_t e = {{0, 0, 0}, {1, 1, 1}, 0, true};
+    for (size_t i = 0; i < n; ++i) {
+        e.id = (uint32_t)i;
+        array_append(entities, e);
+        array_append(handles, (uint32_t)i);
+    }
+
+    uint32_t x = 2463534242u;
+    uint64_t sum = 0;
+    const double begin = now_ms();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (size_t i = 0; i < churn; ++i) {
+            const size_t victim = next_random(&x) % n;
+            entities[handles[victim]].alive = false;
+            array_append(free_list, handles[victim]);
+            e.id = x;
+            const uint32_t index = array_back(free_list);
+            array_resize(free_list, array_size(free_list) - 1);
+            entities[index] = e;
+            handles[victim] = index;
+        }
+        const size_t size = array_size(entities);
+        for (size_t i = 0; i < size; ++i) {
+            entity_t* const itr = entities + i;
+            if (!itr->alive) continue;
+            itr->position[0] += itr->velocity[0];
+            sum += itr->id;
+        }
+        for (size_t i = 0; i < churn; ++i) {
+            sum += entities[handles[next_random(&x) % n]].id;
+        }
+    }
+    const double elapsed = now_ms() - begin;
+    sink = sum;
+
+    array_free(handles);
+    array_free(free_list);
+    array_free(entities);
+    return elapsed / frames;
+}
+
+
+// the same workload using array_remove(), which keeps the array dense and
+// ordered but must shift every later element
+static double bench_remove(const size_t n, const size_t churn, const int frames) {
+    array_t(entity_t) entities = NULL;
+    array_alloc(entities, n, NULL);
+    entity_t e = {{0, 0, 0}, {1, 1, 1}, 0, true};
+    for (size_t i = 0; i < n; ++i) {
+        e.id = (uint32_t)i;
+        array_append(entities, e);
+    }
+
+    uint32_t x = 2463534242u;
+    uint64_t sum = 0;
+    const double begin = now_ms();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (size_t i = 0; i < churn; ++i) {
+            array_remove(entities, next_random(&x) % n);
+            e.id = x;
+            array_append(entities, e);
+        }
+        const size_t size = array_size(entities);
+        for (size_t i = 0; i < size; ++i) {
+            entity_t* const itr = entities + i;
+            itr->position[0] += itr->velocity[0];
+            sum += itr->id;
+        }
+        for (size_t i = 0; i < churn; ++i) {
+            sum += entities[next_random(&x) % n].id;
+        }
+    }
+    const double elapsed = now_ms() - begin;
+    sink = sum;
+
+    array_free(entities);
+    return elapsed / frames;
+}
+
+
+// iterates after removing every other entity, when the slot map's storage
+// stays dense and the holes array is half empty
+static void bench_drained(const size_t n, const int frames, double* slotmap_ms, double* holes_ms) {
+    typedef slotmap_t(entity_t) entity_map;
+    entity_map m = {0};
+    array_t(slotmap_handle_t) handles = NULL;
+    array_t(entity_t) entities = NULL;
+    slotmap_alloc(m, n, NULL);
+    array_alloc(handles, n, NULL);
+    array_alloc(entities, n, NULL);
+    entity_t e = {{0, 0, 0}, {1, 1, 1}, 0, true};
+    for (size_t i = 0; i < n; ++i) {
+        e.id = (uint32_t)i;
+        array_append(handles, slotmap_insert(m, e));
+        array_append(entities, e);
+    }
+    for (size_t i = 0; i < n; i += 2) {
+        slotmap_remove(m, handles[i]);
+        entities[i].alive = false;
+    }
+
+    uint64_t sum = 0;
+    double begin = now_ms();
+    for (int frame = 0; frame < frames; ++frame) {
+        const size_t size = slotmap_size(m);
+        for (size_t i = 0; i < size; ++i) {
+            entity_t* const itr = m.values + i;
+            itr->position[0] += itr->velocity[0];
+            sum += itr->id;
+        }
+    }
+    *slotmap_ms = (now_ms() - begin) / frames;
+
+    begin = now_ms();
+    for (int frame = 0; frame < frames; ++frame) {
+        const size_t size = array_size(entities);
+        for (size_t i = 0; i < size; ++i) {
+            entity_t* const itr = entities + i;
+            if (!itr->alive) continue;
+            itr->position[0] += itr->velocity[0];
+            sum += itr->id;
+        }
+    }
+    *holes_ms = (now_ms() - begin) / frames;
+    sink = sum;
+
+    array_free(entities);
+    array_free(handles);
+    slotmap_free(m);
+}
+
+
+int main(int argc, const char* argv[]) {
+    const int frames = (argc > 1) ? atoi(argv[1]) : 100;
+    printf("%10s %8s %12s %12s %12s   (ms per frame)\n",
+        "entities", "churn", "slotmap", "holes", "array_remove");
+    for (size_t n = 1000; n <= 1000000; n *= 10) {
+        const size_t churn = n / 100;
+        printf("%10zu %8zu %12.3f %12.3f %12.3f\n", n, churn,
+            bench_slotmap(n, churn, frames),
+            bench_holes(n, churn, frames),
+            bench_remove(n, churn, n >= 1000000 ? 1 : frames));
+    }
+
+    printf("\n%10s %8s %12s %12s   (ms per iteration, half removed)\n",
+        "entities", "", "slotmap", "holes");
+    for (size_t n = 1000; n <= 1000000; n *= 10) {
+        double slotmap_ms, holes_ms;
+        bench_drained(n, frames, &slotmap_ms, &holes_ms);
+        printf("%10zu %8s %12.3f %12.3f\n", n, "", slotmap_ms, holes_ms);
+    }
+}
@@ -1,5 +1,9 @@
 #include <stdio.h>
+#include <string.h>
 #include <array.h>
+#include <bitarray.h>
+#include <packedarray.h>
+#include <slotmap.h>
 
 
 #ifndef test
@@ -24,6 +28,21 @@ void destructed_element_count_destructor(int* begin, int* end) {
 }
 
 
+int int_compare(const int* a, const int* b, void* context) {
+    test(context == (void*)&destructed_element_count);
+    return (*a > *b) - (*a < *b);
+}
+
+
+// a stride that is neither a power of two nor a multiple of 32 bytes
+typedef struct { int key; char name[72]; } named_int;
+
+
+int named_int_compare(const named_int* a, const named_int* b, void* context) {
+    return int_compare(&a->key, &b->key, context);
+}
+
+
 int main(int argc, const char* argv[]) {
     array_t(int) a = NULL;
     test(array_size(a) == 0);
@@ -174,6 +193,228 @@ int main(int argc, const char* argv[]) {
     test(a == NULL);
     test(array_size(a) == 0);
     test(array_capacity(a) == 0);
+    test(destructed_element_count == TEST_LENGTH);
+    destructed_element_count = 0;
+
+
+    for (size_t arity = 2; arity <= 5; ++arity) {
+        void* const context = (void*)&destructed_element_count;
+        array_alloc(a, 0, NULL);
+        for (int i = 0; i < TEST_LENGTH; ++i) {
+            array_heap_push(a, (i * 7919) % TEST_LENGTH, arity, int_compare, context);
+            test(array_heap_top(a) == 0);
+        }
+        test(array_size(a) == TEST_LENGTH);
+        for (int i = 0; i < TEST_LENGTH / 2; ++i) {
+            test(array_heap_pop(a, arity, int_compare, context) == i);
+        }
+        test(array_size(a) == TEST_LENGTH / 2);
+        test(array_heap_top(a) == TEST_LENGTH / 2);
+
+        a[array_size(a) - 1] = -1;
+        array_heap_update(a, array_size(a) - 1, arity, int_compare, context);
+        test(array_heap_top(a) == -1);
+        array_heap_top(a) = TEST_LENGTH;
+        array_heap_update(a, 0, arity, int_compare, context);
+        test(array_heap_pop(a, arity, int_compare, context) == TEST_LENGTH / 2);
+
+        array_clear(a);
+        for (int i = 0; i < TEST_LENGTH; ++i) {
+            array_append(a, TEST_LENGTH - 1 - i);
+        }
+        array_heap_make(a, arity, int_compare, context);
+        for (int i = 0; i < TEST_LENGTH; ++i) {
+            test(array_heap_pop(a, arity, int_compare, context) == i);
+        }
+        test(array_size(a) == 0);
+        array_free(a);
+    }
+
+
+    {
+        void* const context = (void*)&destructed_element_count;
+        array_t(named_int) h = NULL;
+        array_alloc(h, 0, NULL);
+        for (int i = 0; i < TEST_LENGTH; ++i) {
+            named_int n = { (i * 7919) % TEST_LENGTH, {0} };
+            snprintf(n.name, sizeof(n.name), "%71d", n.key);
+            array_heap_push(h, n, 4, named_int_compare, context);
+        }
+        for (int i = 0; i < TEST_LENGTH; ++i) {
+            const named_int n = array_heap_pop(h, 4, named_int_compare, context);
+            char name[sizeof(n.name)];
+            snprintf(name, sizeof(name), "%71d", i);
+            test(n.key == i);
+            test(memcmp(n.name, name, sizeof(name)) == 0);
+        }
+        array_free(h);
+    }
+
+
+    {
+        typedef slotmap_t(int) int_slotmap;
+        int_slotmap m = {0};
+        slotmap_handle_t handles[TEST_LENGTH];
+
+        slotmap_alloc(m, 0, destructed_element_count_destructor);
+        test(slotmap_size(m) == 0);
+        test(!slotmap_contains(m, 0));
+        for (int i = 0; i < TEST_LENGTH; ++i) {
+            handles[i] = slotmap_insert(m, i);
+            test(handles[i] != 0);
+            test(*slotmap_get(m, handles[i]) == i);
+        }
+        test(slotmap_size(m) == TEST_LENGTH);
+
+        for (int i = 0; i < TEST_LENGTH; i += 2) {
+            test(slotmap_remove(m, handles[i]));
+            test(!slotmap_contains(m, handles[i]));
+            test(slotmap_get(m, handles[i]) == NULL);
+            test(!slotmap_remove(m, handles[i]));
+        }
+        test(!slotmap_remove(m, 0));
+        test(slotmap_size(m) == TEST_LENGTH / 2);
+        test(destructed_element_count == TEST_LENGTH / 2);
+        destructed_element_count = 0;
+        for (int i = 1; i < TEST_LENGTH; i += 2) {
+            test(slotmap_contains(m, handles[i]));
+            test(*slotmap_get(m, handles[i]) == i);
+        }
+        for (size_t i = 0; i < slotmap_size(m); ++i) {
+            const slotmap_handle_t h = slotmap_handle(m, i);
+            test(slotmap_get(m, h) == &m.values[i]);
+        }
+
+        for (int i = 0; i < TEST_LENGTH; i += 2) {
+            const slotmap_handle_t h = slotmap_insert(m, -i);
+            test(h != handles[i]);
+            test((uint32_t)h < TEST_LENGTH);
+            test(*slotmap_get(m, h) == -i);
+            test(slotmap_get(m, handles[i]) == NULL);
+        }
+        test(slotmap_size(m) == TEST_LENGTH);
+        test(array_size(m.slots) == TEST_LENGTH);
+
+        const slotmap_handle_t h = slotmap_handle(m, 0);
+        slotmap_clear(m);
+        test(slotmap_size(m) == 0);
+        test(!slotmap_contains(m, h));
+        test(destructed_element_count == TEST_LENGTH);
+        destructed_element_count = 0;
+
+        handles[0] = slotmap_insert(m, 123);
+        test(*slotmap_get(m, handles[0]) == 123);
+        slotmap_free(m);
+        test(m.values == NULL);
+        test(slotmap_size(m) == 0);
+        test(destructed_element_count == 1);
+        destructed_element_count = 0;
+    }
+
+
+    {
+        bitarray_t b = {0}, c = {0};
+        bitarray_alloc(b, 0);
+        bitarray_alloc(c, 0);
+        test(bitarray_size(b) == 0);
+        test(bitarray_popcount(b) == 0);
+        test(bitarray_find_first_set(b) == 0);
+        for (int i = 0; i < TEST_LENGTH + 3; ++i) {
+            bitarray_append(b, i % 3 == 0);
+            bitarray_append(c, i % 2 == 0);
+        }
+        test(bitarray_size(b) == TEST_LENGTH + 3);
+        test(array_size(b.words) == (TEST_LENGTH + 3 + 63) / 64);
+        for (int i = 0; i < TEST_LENGTH + 3; ++i) {
+            test(bitarray_get(b, i) == (i % 3 == 0));
+        }
+        test(bitarray_popcount(b) == (TEST_LENGTH + 3 + 2) / 3);
+        test(bitarray_find_first_set(b) == 0);
+        bitarray_set(b, 0, false);
+        test(!bitarray_get(b, 0));
+        test(bitarray_find_first_set(b) == 3);
+        bitarray_set(b, 0, true);
+
+        bitarray_and(b, c);
+        for (int i = 0; i < TEST_LENGTH + 3; ++i) {
+            test(bitarray_get(b, i) == (i % 6 == 0));
+        }
+        bitarray_or(b, c);
+        for (int i = 0; i < TEST_LENGTH + 3; ++i) {
+            test(bitarray_get(b, i) == (i % 2 == 0));
+        }
+        bitarray_and(b, b);
+        bitarray_or(b, b);
+        for (int i = 0; i < TEST_LENGTH + 3; ++i) {
+            test(bitarray_get(b, i) == (i % 2 == 0));
+        }
+        bitarray_xor(b, c);
+        test(bitarray_popcount(b) == 0);
+        bitarray_xor(c, c);
+        test(bitarray_popcount(c) == 0);
+        test(bitarray_find_first_set(b) == TEST_LENGTH + 3);
+
+        bitarray_set(b, TEST_LENGTH + 2, true);
+        bitarray_resize(b, TEST_LENGTH + 1);
+        test(bitarray_popcount(b) == 0);
+        bitarray_resize(b, TEST_LENGTH + 3);
+        test(!bitarray_get(b, TEST_LENGTH + 2));
+        test(bitarray_popcount(b) == 0);
+
+        bitarray_free(b);
+        bitarray_free(c);
+        test(b.words == NULL);
+        test(bitarray_size(b) == 0);
+    }
+
+
+    {
+        array_t(uint32_t) keys32 = NULL;
+        array_t(uint64_t) keys64 = NULL;
+        array_alloc(keys32, 0, NULL);
+        array_alloc(keys64, 0, NULL);
+        for (uint32_t i = 0; i < TEST_LENGTH + 5; ++i) {
+            array_append(keys32, 1000000 + i * 3 + (i & 1));
+            array_append(keys64, ((uint64_t)1 << 40) + (uint64_t)i * i * i * 4099);
+        }
+        array_append(keys64, ~((uint64_t)0));
+        array_append(keys64, 0);
+
+        packedarray_t p32 = {0}, p64 = {0};
+        packedarray_encode(p32, keys32);
+        packedarray_encode(p64, keys64);
+        test(packedarray_size(p32) == array_size(keys32));
+        test(packedarray_size(p64) == array_size(keys64));
+        test(array_size(p32.words) * 8 < array_size(keys32) * 4 / 2);
+        for (size_t i = 0; i < array_size(keys32); ++i) {
+            test(packedarray_get(p32, i) == keys32[i]);
+        }
+        for (size_t i = 0; i < array_size(keys64); ++i) {
+            test(packedarray_get(p64, i) == keys64[i]);
+        }
+
+        array_t(uint32_t) decoded32 = NULL;
+        array_t(uint64_t) decoded64 = NULL;
+        array_alloc(decoded32, 0, NULL);
+        array_alloc(decoded64, 0, NULL);
+        for (size_t i = 0; i < packedarray_block_count(p32); ++i) {
+            packedarray_decode_block(p32, i, decoded32);
+        }
+        for (size_t i = 0; i < packedarray_block_count(p64); ++i) {
+            packedarray_decode_block(p64, i, decoded64);
+        }
+        test(array_compare(decoded32, keys32) == 0);
+        test(array_compare(decoded64, keys64) == 0);
+
+        array_free(decoded32);
+        array_free(decoded64);
+        packedarray_free(p32);
+        packedarray_free(p64);
+        test(p32.blocks == NULL);
+        test(packedarray_size(p32) == 0);
+        array_free(keys32);
+        array_free(keys64);
+    }
 
 
     puts("array tests passed");